@@ -21,6 +21,9 @@ static std::mutex node_ID_map_mutex_[MAP_SIZE_THREAD];
 
 class Block;
 
+// partition reorder set
+enum reorder_set {no_reorder = 0, bfs_reorder = 1, rcm_reorder = 2, degree_reorder = 3};
+
 // table class
 class Table {
 private:
@@ -44,6 +47,9 @@ public:
   void set_header(const std::vector<std::string> &header) {
     header_ = header;
   }
+  void set_matrix(const std::vector<std::vector<std::string> > &matrix) {
+    matrix_ = matrix;
+  }
   void AddRow(const std::vector<std::string> &row) {
     matrix_.push_back(row);
   }
@@ -171,6 +177,8 @@ public:
 class Partition: public Graph {
 private:
   std::set<std::string> node_set_, edge_dst_set_;
+  // node ID to new row map written after reordering
+  Table reorder_table_;
 public:  
   int MyNodeSize() const {
     return node_table_.MyNodeSize();
@@ -178,6 +186,9 @@ public:
   Table my_node_table() const {
     return node_table_;
   }
+  Table my_reorder_table() const {
+    return reorder_table_;
+  }
   // return 1 if node in partition node set
   int IsInNodeSet(const std::string &node) const {
     return node_set_.find(node) != node_set_.end();
@@ -207,9 +218,14 @@ public:
   int CrossEdge(const Block &block);
   // add block to partition
   void AddBlock(Block block);
+  // reorder nodes and edges of partition for locality
+  void Reorder(enum reorder_set reorder_type);
 };
 
 // We sort the blocks in descending order of their sizes
 bool CmpByBlockNodeSize(Block &left, Block& right);
 
+// Reorder partitions in parallel, one thread per partition
+void ReorderPartitions(std::vector<Partition> &partitions, enum reorder_set reorder_type);
+
 #endif
\ No newline at end of file
@@ -13,6 +13,10 @@ const int k_hop = 1;
 // Floating point comparison error
 const double eps = 1e-6;
 
+// Cost of a cut edge across hosts and across workers on the same host
+const double cross_host_cost = 10.0;
+const double cross_worker_cost = 1.0;
+
 // log level
 enum log_level_set {off = 0, fatal = 1, error = 2, warn = 3, info = 4, debug = 5, trace = 6};
 enum log_level_set log_level = info;
@@ -20,7 +24,20 @@ enum log_level_set log_level = info;
 // Assign block using algorithm 2
 std::vector<Partition> AssignBlock(const std::vector<Block> &blocks, int partition_num, double alpha_div_Ctrain, double beta_div_Cval, double gamma_div_Ctest);
 
+// Assign block using algorithm 2 and record the partition of each block
+std::vector<Partition> AssignBlock(const std::vector<Block> &blocks, int partition_num, double alpha_div_Ctrain, double beta_div_Cval, double gamma_div_Ctest, std::vector<int> &block_partition);
+
+// Assign block to hosts first, then to workers of each host in parallel
+// partition k is worker k % workers_per_host of host k / workers_per_host
+std::vector<Partition> AssignHierarchicalBlock(const std::vector<Block> &blocks, int hosts, int workers_per_host, double alpha, double beta, double gamma);
+
 // Generate metadata from partitions
 std::vector<std::pair<std::string,int> > GenerateMetadata(std::vector<Partition> partitions);
 
+// Generate metadata with partition, host and worker ID from hierarchical partitions
+Table GenerateHierarchicalMetadata(const std::vector<Partition> &partitions, int workers_per_host, const std::string &id_header);
+
+// Generate cost-weighted cut report per level from hierarchical partitions
+Table GenerateCutReport(const std::vector<Partition> &partitions, int workers_per_host);
+
 #endif
\ No newline at end of file
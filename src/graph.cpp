@@ -206,4 +206,149 @@ void Partition::SetHeader(const Graph &graph) {
 // We sort the blocks in descending order of their sizes
 bool CmpByBlockNodeSize(Block &left, Block& right) {
   return left.MyNodeSize() > right.MyNodeSize();
+}
+
+// reorder nodes and edges of partition for locality
+// Rows are appended block by block, so the order is effectively random
+// relative to graph structure. Reorder nodes by BFS from the seeds,
+// reverse Cuthill-McKee or degree, then sort edges by (src, dst)
+// in the new order and keep the old node ID to new row map.
+void Partition::Reorder(enum reorder_set reorder_type) {
+  if (reorder_type == no_reorder) return;
+  std::vector<std::vector<std::string> > node_matrix = node_table_.my_matrix(),
+                                         edge_matrix = edge_table_.my_matrix();
+  int node_size = node_matrix.size();
+
+  // build undirected adjacency between nodes inside partition
+  std::map<std::string,int> node_index_map;
+  for (int k = 0; k < node_size; ++k) {
+    node_index_map[node_matrix[k][0]] = k;
+  }
+  std::vector<std::vector<int> > adjacency(node_size);
+  for (auto row: edge_matrix) {
+    auto src = node_index_map.find(row[0]), dst = node_index_map.find(row[1]);
+    if (src == node_index_map.end() || dst == node_index_map.end()) continue;
+    adjacency[src->second].push_back(dst->second);
+    adjacency[dst->second].push_back(src->second);
+  }
+  for (auto &neighbors: adjacency) {
+    sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(unique(neighbors.begin(), neighbors.end()), neighbors.end());
+  }
+  auto cmp_by_degree = [&adjacency](int left, int right) {
+    return adjacency[left].size() < adjacency[right].size();
+  };
+
+  // order[new index] = old index
+  std::vector<int> order;
+  std::vector<bool> visited(node_size, false);
+  if (reorder_type == bfs_reorder || reorder_type == rcm_reorder) {
+    // BFS starts from the seeds, RCM from the unvisited node of minimum degree
+    std::vector<int> starts;
+    if (reorder_type == bfs_reorder) {
+      for (auto item: Merge(train_array_, val_array_, test_array_).my_vector()) {
+        if (node_index_map.find(item) != node_index_map.end()) {
+          starts.push_back(node_index_map[item]);
+        }
+      }
+      for (int k = 0; k < node_size; ++k) {
+        starts.push_back(k);
+      }
+    }
+    else {
+      for (int k = 0; k < node_size; ++k) {
+        starts.push_back(k);
+      }
+      stable_sort(starts.begin(), starts.end(), cmp_by_degree);
+    }
+    for (auto start: starts) {
+      if (visited[start]) continue;
+      std::queue<int> queue;
+      queue.push(start);
+      visited[start] = true;
+      while (!queue.empty()) {
+        int front = queue.front();
+        queue.pop();
+        order.push_back(front);
+        std::vector<int> neighbors = adjacency[front];
+        // Cuthill-McKee visits neighbors in ascending order of degree
+        if (reorder_type == rcm_reorder) {
+          stable_sort(neighbors.begin(), neighbors.end(), cmp_by_degree);
+        }
+        for (auto node: neighbors) {
+          if (visited[node]) continue;
+          visited[node] = true;
+          queue.push(node);
+        }
+      }
+    }
+    if (reorder_type == rcm_reorder) {
+      reverse(order.begin(), order.end());
+    }
+  }
+  if (reorder_type == degree_reorder) {
+    // high degree nodes first
+    for (int k = 0; k < node_size; ++k) {
+      order.push_back(k);
+    }
+    stable_sort(order.begin(), order.end(), [&adjacency](int left, int right) {
+      return adjacency[left].size() > adjacency[right].size();
+    });
+  }
+
+  // rank[old index] = new index, nodes outside partition go last
+  std::vector<int> rank(node_size);
+  for (int k = 0; k < node_size; ++k) {
+    rank[order[k]] = k;
+  }
+  auto node_rank = [&node_index_map, &rank, node_size](const std::string &node) {
+    auto iter = node_index_map.find(node);
+    return iter == node_index_map.end() ? node_size : rank[iter->second];
+  };
+
+  // rewrite node table in new order and record node ID to new row map
+  std::vector<std::vector<std::string> > reorder_node_matrix;
+  reorder_table_ = Table();
+  reorder_table_.set_header({node_table_.my_header().empty() ? "id:int64" : node_table_.my_header()[0], "new-row:int64"});
+  for (int k = 0; k < node_size; ++k) {
+    reorder_node_matrix.push_back(node_matrix[order[k]]);
+    reorder_table_.AddRow({node_matrix[order[k]][0], std::to_string(k)});
+  }
+  node_table_.set_matrix(reorder_node_matrix);
+
+  // Edges are sorted by (src, dst) in the new order,
+  // dst outside partition goes last and is sorted by its int64 ID
+  std::vector<int> src_rank, dst_rank, edge_order;
+  for (int k = 0; k < edge_matrix.size(); ++k) {
+    src_rank.push_back(node_rank(edge_matrix[k][0]));
+    dst_rank.push_back(node_rank(edge_matrix[k][1]));
+    edge_order.push_back(k);
+  }
+  stable_sort(edge_order.begin(), edge_order.end(), [&](int left, int right) {
+    if (src_rank[left] != src_rank[right]) return src_rank[left] < src_rank[right];
+    if (dst_rank[left] != dst_rank[right]) return dst_rank[left] < dst_rank[right];
+    if (dst_rank[left] != node_size) return false;
+    const std::string &left_dst = edge_matrix[left][1], &right_dst = edge_matrix[right][1];
+    if (left_dst.length() != right_dst.length()) return left_dst.length() < right_dst.length();
+    return left_dst < right_dst;
+  });
+  std::vector<std::vector<std::string> > reorder_edge_matrix;
+  for (auto k: edge_order) {
+    reorder_edge_matrix.push_back(edge_matrix[k]);
+  }
+  edge_table_.set_matrix(reorder_edge_matrix);
+  if (log_level_graph >= debug) printf("DEBUG: reorder partition node size %d edge size %d\n", node_size, (int)edge_matrix.size());
+}
+
+// Reorder partitions in parallel, one thread per partition
+void ReorderPartitions(std::vector<Partition> &partitions, enum reorder_set reorder_type) {
+  if (reorder_type == no_reorder) return;
+  std::vector<std::thread> thread_vector;
+  for (auto &partition: partitions) {
+    std::thread thread(&Partition::Reorder, &partition, reorder_type);
+    thread_vector.push_back(std::move(thread));
+  }
+  for(auto &thread : thread_vector) {
+      thread.join();
+  }
 }
\ No newline at end of file
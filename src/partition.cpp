@@ -2,7 +2,14 @@
 
 // Assign block using algorithm 2
 std::vector<Partition> AssignBlock(const std::vector<Block> &blocks, int partition_num, double alpha_div_Ctrain, double beta_div_Cval, double gamma_div_Ctest) {
+  std::vector<int> block_partition;
+  return AssignBlock(blocks, partition_num, alpha_div_Ctrain, beta_div_Cval, gamma_div_Ctest, block_partition);
+}
+
+// Assign block using algorithm 2 and record the partition of each block
+std::vector<Partition> AssignBlock(const std::vector<Block> &blocks, int partition_num, double alpha_div_Ctrain, double beta_div_Cval, double gamma_div_Ctest, std::vector<int> &block_partition) {
   std::vector<Partition> partitions(partition_num);
+  block_partition.assign(blocks.size(), 0);
   std::vector<double> CE(partition_num), BS(partition_num);
   for (int i = 0; i < blocks.size(); ++i) {
     for (int j = 0; j < partition_num; ++j) {
@@ -24,11 +31,60 @@ std::vector<Partition> AssignBlock(const std::vector<Block> &blocks, int partiti
       }
     }
     partitions[x].AddBlock(blocks[i]);
+    block_partition[i] = x;
     if (log_level >= debug) printf("DEBUG: assign block %d to partition %d block size %d\n", i, x, blocks[i].MyNodeSize());
 	}
   return partitions;
 }
 
+// Assign block to hosts first, then to workers of each host in parallel
+// Cross-host edges are far more expensive than cross-worker edges,
+// so the CE x BS objective is first applied across hosts, and then
+// each host's share is sub-partitioned across its workers.
+// Both levels weight the balance score like the flat AssignBlock call,
+// so 1 x N gives the same partitions as N.
+std::vector<Partition> AssignHierarchicalBlock(const std::vector<Block> &blocks, int hosts, int workers_per_host, double alpha, double beta, double gamma) {
+  // Assign block to hosts
+  int train_size = 0;
+  for (auto &block: blocks) {
+    train_size += block.MyTrainSize();
+  }
+  std::vector<int> block_host;
+  AssignBlock(blocks, hosts, alpha * train_size / hosts, beta, gamma, block_host);
+
+  // Blocks keep descending order of their sizes inside each host
+  std::vector<std::vector<Block> > host_blocks(hosts);
+  for (int i = 0; i < blocks.size(); ++i) {
+    host_blocks[block_host[i]].push_back(blocks[i]);
+  }
+
+  // Sub-partition each host's share in parallel
+  std::vector<std::vector<Partition> > host_partitions(hosts);
+  std::vector<std::thread> thread_vector;
+  for (int h = 0; h < hosts; ++h) {
+    std::thread thread([&host_blocks, &host_partitions, h, workers_per_host, alpha, beta, gamma]() {
+      int host_train_size = 0;
+      for (auto &block: host_blocks[h]) {
+        host_train_size += block.MyTrainSize();
+      }
+      host_partitions[h] = AssignBlock(host_blocks[h], workers_per_host, alpha * host_train_size / workers_per_host, beta, gamma);
+    });
+    thread_vector.push_back(std::move(thread));
+  }
+  for(auto &thread : thread_vector) {
+      thread.join();
+  }
+
+  std::vector<Partition> partitions;
+  for (int h = 0; h < hosts; ++h) {
+    for (int w = 0; w < workers_per_host; ++w) {
+      if (log_level >= debug) printf("DEBUG: host %d worker %d node size %d\n", h, w, host_partitions[h][w].MyNodeSize());
+      partitions.push_back(host_partitions[h][w]);
+    }
+  }
+  return partitions;
+}
+
 // Generate metadata from partitions
 std::vector<std::pair<std::string,int> > GenerateMetadata(std::vector<Partition> partitions) {
   std::vector<std::pair<std::string,int> > metadata;
@@ -40,19 +96,73 @@ std::vector<std::pair<std::string,int> > GenerateMetadata(std::vector<Partition>
   return metadata;
 }
 
+// Generate metadata with partition, host and worker ID from hierarchical partitions
+Table GenerateHierarchicalMetadata(const std::vector<Partition> &partitions, int workers_per_host, const std::string &id_header) {
+  Table metadata;
+  metadata.set_header({id_header, "partition-id:int64", "host-id:int64", "worker-id:int64"});
+  for (int k = 0; k < partitions.size(); ++k) {
+    for (auto row: partitions[k].my_node_table().my_matrix()) {
+      metadata.AddRow({row[0], std::to_string(k), std::to_string(k / workers_per_host), std::to_string(k % workers_per_host)});
+    }
+  }
+  return metadata;
+}
+
+// Generate cost-weighted cut report per level from hierarchical partitions
+// An edge is cut at host level if its endpoints are on different hosts,
+// and at worker level if they are on different workers of the same host.
+Table GenerateCutReport(const std::vector<Partition> &partitions, int workers_per_host) {
+  std::map<std::string,int> node_partition_map;
+  for (int k = 0; k < partitions.size(); ++k) {
+    for (auto row: partitions[k].my_node_table().my_matrix()) {
+      node_partition_map[row[0]] = k;
+    }
+  }
+  int host_cut = 0, worker_cut = 0;
+  for (int k = 0; k < partitions.size(); ++k) {
+    for (auto row: partitions[k].my_edge_table().my_matrix()) {
+      auto dst = node_partition_map.find(row[1]);
+      if (dst == node_partition_map.end() || dst->second == k) continue;
+      if (dst->second / workers_per_host != k / workers_per_host) ++host_cut;
+      else ++worker_cut;
+    }
+  }
+  if (log_level >= info) printf("INFO: host level cut edges %d cost %lf\n", host_cut, host_cut * cross_host_cost);
+  if (log_level >= info) printf("INFO: worker level cut edges %d cost %lf\n", worker_cut, worker_cut * cross_worker_cost);
+  Table cut_report;
+  cut_report.set_header({"level:string", "cut-edges:int64", "cost:double", "weighted-cut:double"});
+  cut_report.AddRow({"host", std::to_string(host_cut), std::to_string(cross_host_cost), std::to_string(host_cut * cross_host_cost)});
+  cut_report.AddRow({"worker", std::to_string(worker_cut), std::to_string(cross_worker_cost), std::to_string(worker_cut * cross_worker_cost)});
+  cut_report.AddRow({"total", std::to_string(host_cut + worker_cut), "-", std::to_string(host_cut * cross_host_cost + worker_cut * cross_worker_cost)});
+  return cut_report;
+}
+
 // main function
 int main(int argc,char *argv[]) {
   printf("log level = %d\n", log_level);
   // Check the validity of command line arguments
   if (argc < 6) {
-    printf("Command: ./partition input_folder output_folder partition_num alpha beta gamma");
+    printf("Command: ./partition input_folder output_folder partition_num|hostsxworkers_per_host alpha beta gamma [none|bfs|rcm|degree]");
     return 0;
   }
 
   // Extract command line arguments
   std::string input_folder(argv[1]),
               output_folder(argv[2]);
+  // hierarchical mode if partition_num is given as hosts x workers_per_host
+  std::string partition_arg(argv[3]);
+  int hosts = 0, workers_per_host = 0;
   int partition_num = atoi(argv[3]);
+  if (partition_arg.find('x') != std::string::npos) {
+    char *hosts_end = NULL, *workers_end = NULL;
+    hosts = strtol(argv[3], &hosts_end, 10);
+    if (*hosts_end == 'x') workers_per_host = strtol(hosts_end + 1, &workers_end, 10);
+    if (*hosts_end != 'x' || *workers_end != '\0' || hosts <= 0 || workers_per_host <= 0) {
+      if (log_level >= error) printf("ERROR: invalid hosts x workers_per_host %s\n", argv[3]);
+      return 0;
+    }
+    partition_num = hosts * workers_per_host;
+  }
   if (!partition_num) {
     if (log_level >= error) printf("ERROR: partition_num = 0\n");
     return 0;
@@ -60,6 +170,18 @@ int main(int argc,char *argv[]) {
   double alpha = atof(argv[4]),
         beta = atof(argv[5]),
         gamma = atof(argv[6]);
+  // optional reorder of nodes and edges inside each partition
+  enum reorder_set reorder_type = no_reorder;
+  if (argc > 7) {
+    std::string reorder(argv[7]);
+    if (reorder == "bfs") reorder_type = bfs_reorder;
+    else if (reorder == "rcm") reorder_type = rcm_reorder;
+    else if (reorder == "degree") reorder_type = degree_reorder;
+    else if (reorder != "none") {
+      if (log_level >= error) printf("ERROR: unknown reorder %s\n", reorder.c_str());
+      return 0;
+    }
+  }
 
   // read graph from file
   if (log_level >= info) printf("INFO: reading graph from file\n");
@@ -74,20 +196,41 @@ int main(int argc,char *argv[]) {
   double alpha_div_Ctrain = alpha * graph.MyTrainSize() / partition_num,
         beta_div_Cval = beta * graph.MyValSize() / partition_num,
         gamma_div_Ctest = gamma * graph.MyTestSize() / partition_num;
-  std::vector<Partition> partitions = AssignBlock(blocks, partition_num, alpha_div_Ctrain, beta, gamma);
+  std::vector<Partition> partitions;
+  if (hosts) {
+    if (log_level >= info) printf("INFO: hierarchical mode %d hosts x %d workers per host\n", hosts, workers_per_host);
+    partitions = AssignHierarchicalBlock(blocks, hosts, workers_per_host, alpha, beta, gamma);
+  }
+  else {
+    partitions = AssignBlock(blocks, partition_num, alpha_div_Ctrain, beta, gamma);
+  }
   // Set partition header using graph
   for (auto &partition: partitions) {
     partition.SetHeader(graph);
   }
 
+  // Reorder nodes and edges inside each partition for locality
+  if (reorder_type != no_reorder) {
+    if (log_level >= info) printf("INFO: reordering partitions for locality\n");
+    ReorderPartitions(partitions, reorder_type);
+  }
+
   // Generate metadata and header for partitions
   if (log_level >= info) printf("INFO: generating metadata and header for partitions\n");
-  std::vector<std::pair<std::string,int> > metadata = GenerateMetadata(partitions);
   std::pair<std::string,std::string > metadata_header = make_pair(graph.my_node_table().my_header()[0], "partition-id:int64");
   
   // Write metadata to file
   if (log_level >= info) printf("INFO: writing metadata to file\n");
-  WriteMetadata(output_folder, metadata_header, metadata);
+  if (hosts) {
+    WriteTable(output_folder + "/metadata", GenerateHierarchicalMetadata(partitions, workers_per_host, metadata_header.first));
+    // Write cost-weighted cut report per level to file
+    if (log_level >= info) printf("INFO: writing cut report to file\n");
+    WriteTable(output_folder + "/cut_report", GenerateCutReport(partitions, workers_per_host));
+  }
+  else {
+    std::vector<std::pair<std::string,int> > metadata = GenerateMetadata(partitions);
+    WriteMetadata(output_folder, metadata_header, metadata);
+  }
 
   // Write partitions to file
   if (log_level >= info) printf("INFO: writing partitions to file\n");
@@ -108,5 +108,9 @@ void WritePartitions(const std::string &output_folder, const std::vector<Partiti
     WriteArray(part_folder + "/train_table", partitions[k].my_train_array());
     WriteArray(part_folder + "/val_table", partitions[k].my_val_array());
     WriteArray(part_folder + "/test_table", partitions[k].my_test_array());
+    // Write node ID to new row map if partition is reordered
+    if (!partitions[k].my_reorder_table().my_header().empty()) {
+      WriteTable(part_folder + "/reorder_map", partitions[k].my_reorder_table());
+    }
   }
 }
\ No newline at end of file